@@ -0,0 +1,49 @@
+#include "AllocationCounter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+
+std::atomic<uint64_t> s_HeapAllocationCount = {};
+
+}  // namespace
+
+// Replacing global operator new/delete, so this executable's own heap allocations(ours and STL's) go through the counter.
+// Array and nothrow versions of the standard library forward to these ones.
+// NOTE: Not counted: aligned(std::align_val_t) overloads and allocations made inside SFML DLLs, which use their own CRT's operator new.
+void* operator new(std::size_t size)
+{
+    s_HeapAllocationCount.fetch_add(1, std::memory_order_relaxed);
+
+    if (void* memory = std::malloc(size != 0 ? size : 1)) return memory;
+
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+namespace BallCollision
+{
+
+namespace Memory
+{
+
+uint64_t GetHeapAllocationCount()
+{
+    return s_HeapAllocationCount.load(std::memory_order_relaxed);
+}
+
+}  // namespace Memory
+
+}  // namespace BallCollision
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "Core.h"
+
+namespace BallCollision
+{
+
+namespace Memory
+{
+
+// Total number of global operator new calls since startup(all threads).
+// Take the difference around a piece of code to see how many heap allocations it made.
+NODISCARD uint64_t GetHeapAllocationCount();
+
+}  // namespace Memory
+
+}  // namespace BallCollision
@@ -1,6 +1,7 @@
 #include "Application.h"
 
 #include "MiddleAverageFilter.h"
+#include "AllocationCounter.h"
 
 #include <format>  // Convenient text formatting via std::format (C++20 and onwards)
 #include <random>  // Random number generator to replace old srand(time(NULL))
@@ -15,7 +16,7 @@ Application::Application(const std::string_view appName, const uint32_t windowSi
     assert(!appName.empty());
 
     m_CollisionSystem =
-        std::make_unique<CollisionSystem>(sf::Vector2f{static_cast<float>(m_WindowSizeX), static_cast<float>(m_WindowSizeY)});
+        std::make_unique<CollisionSystem>(Ball::Vector2{static_cast<Ball::Scalar>(m_WindowSizeX), static_cast<Ball::Scalar>(m_WindowSizeY)});
 }
 
 void Application::Run()
@@ -36,8 +37,11 @@ void Application::Run()
         fpsCounter.Push(1.0f / (deltaTime));
         lastTime = current_time;
 
+        // Everything from moving balls up to recording history is the step, it's expected to not allocate once warmed up.
+        const uint64_t stepAllocationsBegin = Memory::GetHeapAllocationCount();
+
         for (auto& ball : m_Balls)
-            ball.Move(deltaTime);
+            ball.Move(static_cast<Ball::Scalar>(deltaTime));
 
         sf::Clock eventTimer;
 
@@ -50,11 +54,15 @@ void Application::Run()
         m_CollisionSystem->SolveCollisions(m_Balls);
         const float collisionSolvingEnd = eventTimer.getElapsedTime().asSeconds();
 
+        m_StateHistory.Record(m_Balls);
+
+        const uint64_t stepAllocations = Memory::GetHeapAllocationCount() - stepAllocationsBegin;
+
         m_Window.clear();
         for (const auto& ball : m_Balls)
             DrawBall(ball);
 
-        DrawTimers(fpsCounter.CalculateAverage(), treeBuildEnd - treeBuildBegin, collisionSolvingEnd - collisionSolvingBegin);
+        DrawTimers(fpsCounter.CalculateAverage(), treeBuildEnd - treeBuildBegin, collisionSolvingEnd - collisionSolvingBegin, stepAllocations);
         if (m_bDrawCollisionTree) m_CollisionSystem->DrawDebugColliders(m_Window);
 
         m_Window.display();
@@ -81,7 +89,20 @@ void Application::PollInput()
                 sf::FloatRect visibleArea(0.f, 0.f, static_cast<float>(event.size.width), static_cast<float>(event.size.height));
                 m_Window.setView(sf::View(visibleArea));
 
-                m_CollisionSystem->ResizeCollisionTree(sf::Vector2f{visibleArea.width, visibleArea.height});
+                m_CollisionSystem->ResizeCollisionTree(Ball::Vector2{sf::Vector2f{visibleArea.width, visibleArea.height}});
+                break;
+            }
+            case sf::Event::KeyPressed:
+            {
+                // Jump back in time, simulation continues(and keeps recording) from the restored tick.
+                // Rewinds as far as the history reaches if it's shorter than requested, the outcome is shown in the title.
+                if (event.key.code == sf::Keyboard::Left && !m_StateHistory.IsEmpty())
+                {
+                    const uint64_t tickCount =
+                        std::min<uint64_t>(s_RewindTickCount, m_StateHistory.GetNewestTick() - m_StateHistory.GetOldestTick());
+                    m_LastRewindTickCount = m_StateHistory.Rewind(tickCount, m_Balls) ? tickCount : 0;
+                }
+                break;
             }
         }
     }
@@ -89,9 +110,11 @@ void Application::PollInput()
 
 void Application::DrawBall(const Ball& ball)
 {
-    sf::CircleShape cirle(ball.m_Radius);
-    cirle.setPosition(ball.m_Position);
-    cirle.setOrigin({ball.m_Radius, ball.m_Radius});
+    const auto radius = static_cast<float>(ball.m_Radius);
+
+    sf::CircleShape cirle(radius);
+    cirle.setPosition(sf::Vector2f{ball.GetPosition()});
+    cirle.setOrigin({radius, radius});
 
     // Debugging AABB.
 #if 0
@@ -99,19 +122,23 @@ void Application::DrawBall(const Ball& ball)
     rect.setOutlineThickness(2);
     rect.setOutlineColor(sf::Color::Blue);
     rect.setFillColor(sf::Color::Transparent);
-    rect.setPosition(ball.m_Bounds.left, ball.m_Bounds.top);
-    rect.setSize(sf::Vector2f(ball.m_Bounds.width, ball.m_Bounds.height));
+    const auto bounds = sf::FloatRect{ball.GetBounds()};
+    rect.setPosition(bounds.left, bounds.top);
+    rect.setSize(sf::Vector2f(bounds.width, bounds.height));
     m_Window.draw(rect);
 #endif
 
     m_Window.draw(cirle);
 }
 
-void Application::DrawTimers(const float fps, const float treeBuildTime, const float collisionSolvingTime)
+void Application::DrawTimers(const float fps, const float treeBuildTime, const float collisionSolvingTime, const uint64_t stepAllocations)
 {
-    const auto formattedTitle =
-        std::format("{}, Objects: {}, FPS: {:.2f}, QuadTree Build Time: {:.9f} seconds, Collision Solve Time: {:.9f} seconds", m_AppName,
-                    m_Balls.size(), fps, treeBuildTime, collisionSolvingTime);
+    const auto formattedTitle = std::format("{}, Objects: {}, FPS: {:.2f}, QuadTree Build Time: {:.9f} seconds, Collision Solve Time: {:.9f} "
+                                            "seconds, Step Allocations: {}, History: {} ticks, {}/{} KB, Last Rewind: {}/{} ticks",
+                                            m_AppName, m_Balls.size(), fps, treeBuildTime, collisionSolvingTime, stepAllocations,
+                                            m_StateHistory.GetNewestTick() - m_StateHistory.GetOldestTick() + 1,
+                                            m_StateHistory.GetEncodedSize() / 1024, m_StateHistory.GetMemoryUsage() / 1024,
+                                            m_LastRewindTickCount, s_RewindTickCount);
     m_Window.setTitle(formattedTitle);
 }
 
@@ -138,12 +165,13 @@ void Application::GenerateBalls()
         const float radius = 10 + distribution(generator) % 5;
 
         const sf::Vector2f velocity = direction * speed;
-        m_Balls.emplace_back(position, velocity, radius);
+        m_Balls.emplace_back(Ball::Vector2{position}, Ball::Vector2{velocity}, static_cast<Ball::Scalar>(radius));
     }
 }
 
 void Application::Shutdown()
 {
+    m_StateHistory.Clear();
     m_Balls.clear();
     m_CollisionSystem.reset();
 }
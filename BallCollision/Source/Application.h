@@ -4,6 +4,7 @@
 #include "Core.h"
 #include "Ball.h"
 #include "CollisionSystem.h"
+#include "StateHistory.h"
 
 namespace BallCollision
 {
@@ -31,13 +32,21 @@ class Application final
 
     std::string m_AppName = {};
 
+    // Rewinding by s_RewindTickCount ticks on Left arrow, history keeps up to 10 seconds worth of ticks at 60 FPS
+    // (its byte budget scales with the ball count, see StateHistory::GetByteCapacity()).
+    static constexpr uint32_t s_HistoryTickCount        = 600;
+    static constexpr uint32_t s_HistoryKeyframeInterval = 60;
+    static constexpr uint32_t s_RewindTickCount         = 120;
+
     std::unique_ptr<CollisionSystem> m_CollisionSystem = nullptr;
+    StateHistory m_StateHistory{s_HistoryTickCount, s_HistoryKeyframeInterval};
+    uint64_t m_LastRewindTickCount = {};
     std::vector<Ball> m_Balls;
 
     void PollInput();
 
     void DrawBall(const Ball& ball);
-    void DrawTimers(const float fps, const float treeBuildTime, const float collisionSolvingTime);
+    void DrawTimers(const float fps, const float treeBuildTime, const float collisionSolvingTime, const uint64_t stepAllocations);
 
     void GenerateBalls();
     void Shutdown();
@@ -1,42 +1,54 @@
 #pragma once
 
 #include "Core.h"
+#include "PrecisionPolicy.h"
 
 #include "SFML/Graphics/Rect.hpp"
 
 namespace BallCollision
 {
 
-struct Ball
+template <typename Policy> struct BasicBall
 {
-    Ball(const sf::Vector2f& position,  //
-         const sf::Vector2f& velocity,  //
-         const float radius             //
-         )
-        : m_Position(position),           //
-          m_Velocity(velocity),           //
-          m_Radius(radius),               //
-          m_Mass(s_PI * radius * radius)  //
+    using Scalar          = typename Policy::Scalar;
+    using PositionStorage = typename Policy::PositionStorage;
+    using Vector2         = sf::Vector2<Scalar>;
+    using Rect            = sf::Rect<Scalar>;
+
+    BasicBall(const Vector2& position,  //
+              const Vector2& velocity,  //
+              const Scalar radius       //
+              )
+        : m_Velocity(velocity),                                  //
+          m_Radius(radius),                                      //
+          m_Mass(static_cast<Scalar>(s_PI) * radius * radius)  //
     {
-        UpdateBounds();
+        SetPosition(position);
     }
-    Ball()  = default;
-    ~Ball() = default;
+    BasicBall()  = default;
+    ~BasicBall() = default;
 
-    void UpdateBounds() { m_Bounds = {m_Position.x - m_Radius, m_Position.y - m_Radius, m_Radius * 2.f, m_Radius * 2.f}; }
+    NODISCARD FORCEINLINE Vector2 GetPosition() const { return {Policy::FromStorage(m_Position.x), Policy::FromStorage(m_Position.y)}; }
 
-    void Move(const float deltaTime)
-    {
-        m_Position += m_Velocity * deltaTime;
+    FORCEINLINE void SetPosition(const Vector2& position) { m_Position = {Policy::ToStorage(position.x), Policy::ToStorage(position.y)}; }
 
-        UpdateBounds();
+    // NOTE: Computed from the stored position instead of being cached, so the position is kept in memory only once,
+    // at storage precision(quantized policies don't drag a full precision copy along).
+    NODISCARD FORCEINLINE Rect GetBounds() const
+    {
+        const Vector2 position = GetPosition();
+        return {position.x - m_Radius, position.y - m_Radius, m_Radius * 2, m_Radius * 2};
     }
 
-    sf::Vector2f m_Position = sf::Vector2f{0.f, 0.f};
-    sf::Vector2f m_Velocity = sf::Vector2f{0.f, 0.f};
-    const float m_Radius    = 0.f;
-    const float m_Mass      = 0.f;
-    sf::FloatRect m_Bounds  = {};
+    void Move(const Scalar deltaTime) { SetPosition(GetPosition() + m_Velocity * deltaTime); }
+
+    // Stored as is for floating point policies and quantized for fixed point ones, use Get/SetPosition() to work with it.
+    sf::Vector2<PositionStorage> m_Position = {};
+    Vector2 m_Velocity                      = {};
+    const Scalar m_Radius                   = {};
+    const Scalar m_Mass                     = {};
 };
 
-}  // namespace BallCollision
\ No newline at end of file
+using Ball = BasicBall<SimulationPolicy>;
+
+}  // namespace BallCollision
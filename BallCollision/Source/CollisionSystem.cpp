@@ -3,17 +3,18 @@
 namespace BallCollision
 {
 
-CollisionSystem::CollisionSystem(const sf::Vector2f& screenBounds) noexcept
+template <typename Policy> BasicCollisionSystem<Policy>::BasicCollisionSystem(const Vector2& screenBounds) noexcept
 {
-    m_CollisionTree = std::make_unique<QuadTree<8, 8>>(0, sf::FloatRect{{0, 0}, {screenBounds.x, screenBounds.y}}, nullptr);
+    ResizeCollisionTree(screenBounds);
 }
 
-CollisionSystem::~CollisionSystem()
+template <typename Policy> BasicCollisionSystem<Policy>::~BasicCollisionSystem()
 {
-    m_CollisionTree.reset();
+    m_CollisionTree = nullptr;
+    m_NodePool.Reset();
 }
 
-void CollisionSystem::BuildAccelerationStructure(std::vector<Ball>& balls)
+template <typename Policy> void BasicCollisionSystem<Policy>::BuildAccelerationStructure(std::vector<BallType>& balls)
 {
     assert(!balls.empty());
 
@@ -24,15 +25,17 @@ void CollisionSystem::BuildAccelerationStructure(std::vector<Ball>& balls)
         m_CollisionTree->Insert(&ball);
 }
 
-void CollisionSystem::SolveCollisions(std::vector<Ball>& balls)
+template <typename Policy> void BasicCollisionSystem<Policy>::SolveCollisions(std::vector<BallType>& balls)
 {
+    const auto& screenBounds = m_CollisionTree->GetBounds();
+
     // 1. Resolve static collisions, so one ball can't exist inside the other.
-    std::vector<std::pair<Ball*, Ball*>> collidingBalls = {};
+    m_CollidingBalls.clear();
     for (auto& ball : balls)
     {
-        auto possibleIntersections = m_CollisionTree->QueryPossibleIntersections(ball.m_Bounds);
+        m_CollisionTree->QueryPossibleIntersections(ball.GetBounds(), m_PossibleIntersections);
 
-        for (Ball* otherBall : possibleIntersections)
+        for (BallType* otherBall : m_PossibleIntersections)
         {
             if (!otherBall || &ball == otherBall) continue;
 
@@ -42,79 +45,86 @@ void CollisionSystem::SolveCollisions(std::vector<Ball>& balls)
             const auto& normal       = collisionResult.value().m_Normal;
             const auto overlapLength = collisionResult.value().m_OverlapLength;
 
-            ball.m_Position -= normal * overlapLength;
+            ball.SetPosition(ball.GetPosition() - normal * overlapLength);
 
-            otherBall->m_Position += normal * overlapLength;
-            otherBall->UpdateBounds();
+            otherBall->SetPosition(otherBall->GetPosition() + normal * overlapLength);
 
-            collidingBalls.emplace_back(&ball, otherBall);
+            m_CollidingBalls.emplace_back(&ball, otherBall);
         }
-        ball.UpdateBounds();
 
         // 2. Solve screen bounds.
-        if (ball.m_Position.x - ball.m_Radius <= 0.f || ball.m_Position.x + ball.m_Radius >= m_CollisionTree->GetBounds().width)
+        Vector2 position = ball.GetPosition();
+        if (position.x - ball.m_Radius <= Scalar{0} || position.x + ball.m_Radius >= screenBounds.width)
         {
             ball.m_Velocity.x = -ball.m_Velocity.x;
-            ball.m_Position.x = std::max(ball.m_Radius, std::min(ball.m_Position.x, m_CollisionTree->GetBounds().width - ball.m_Radius));
+            position.x        = std::max(ball.m_Radius, std::min(position.x, screenBounds.width - ball.m_Radius));
 
-            ball.UpdateBounds();
+            ball.SetPosition(position);
         }
 
-        if (ball.m_Position.y - ball.m_Radius <= 0.f || ball.m_Position.y + ball.m_Radius >= m_CollisionTree->GetBounds().height)
+        if (position.y - ball.m_Radius <= Scalar{0} || position.y + ball.m_Radius >= screenBounds.height)
         {
             ball.m_Velocity.y = -ball.m_Velocity.y;
-            ball.m_Position.y = std::max(ball.m_Radius, std::min(ball.m_Position.y, m_CollisionTree->GetBounds().height - ball.m_Radius));
+            position.y        = std::max(ball.m_Radius, std::min(position.y, screenBounds.height - ball.m_Radius));
 
-            ball.UpdateBounds();
+            ball.SetPosition(position);
         }
     }
 
     // 3. Solve an actual dynamic perfectly elastic collisions.
-    for (auto& [ball, target] : collidingBalls)
+    for (auto& [ball, target] : m_CollidingBalls)
     {
         if (!ball || !target || ball == target) continue;
 
-        float distance = std::sqrt((ball->m_Position.x - target->m_Position.x) * (ball->m_Position.x - target->m_Position.x) +
-                                   (ball->m_Position.y - target->m_Position.y) * (ball->m_Position.y - target->m_Position.y));
-        if (distance == 0.0f) distance = s_BC_KINDA_SMALL_NUMBER;
+        const Vector2 distanceVec = ball->GetPosition() - target->GetPosition();
+
+        Scalar distance = std::sqrt(DotProduct(distanceVec, distanceVec));
+        if (distance == Scalar{0}) distance = static_cast<Scalar>(s_BC_KINDA_SMALL_NUMBER);
 
-        const sf::Vector2f normal = (ball->m_Position - target->m_Position) / distance;
-        const sf::Vector2f tangent{-normal.y, normal.x};
+        const Vector2 normal = distanceVec / distance;
+        const Vector2 tangent{-normal.y, normal.x};
 
         // Apply tangential and normal responses.
-        const float firstTangentSpeed  = DotProduct(ball->m_Velocity, tangent);
-        const float secondTangentSpeed = DotProduct(target->m_Velocity, tangent);
+        const Scalar firstTangentSpeed  = DotProduct(ball->m_Velocity, tangent);
+        const Scalar secondTangentSpeed = DotProduct(target->m_Velocity, tangent);
 
-        const float firstSpeed  = DotProduct(ball->m_Velocity, normal);
-        const float secondSpeed = DotProduct(target->m_Velocity, normal);
+        const Scalar firstSpeed  = DotProduct(ball->m_Velocity, normal);
+        const Scalar secondSpeed = DotProduct(target->m_Velocity, normal);
 
-        const float massSum  = ball->m_Mass + target->m_Mass;
-        const float massDiff = ball->m_Mass - target->m_Mass;
+        const Scalar massSum  = ball->m_Mass + target->m_Mass;
+        const Scalar massDiff = ball->m_Mass - target->m_Mass;
 
-        const float firstNormalSpeed  = ((2 * target->m_Mass * secondSpeed) + firstSpeed * massDiff) / massSum;
-        const float secondNormalSpeed = ((2 * ball->m_Mass * firstSpeed) - secondSpeed * massDiff) / massSum;
+        const Scalar firstNormalSpeed  = ((2 * target->m_Mass * secondSpeed) + firstSpeed * massDiff) / massSum;
+        const Scalar secondNormalSpeed = ((2 * ball->m_Mass * firstSpeed) - secondSpeed * massDiff) / massSum;
 
         ball->m_Velocity   = tangent * firstTangentSpeed + normal * firstNormalSpeed;
         target->m_Velocity = tangent * secondTangentSpeed + normal * secondNormalSpeed;
     }
 }
 
-std::optional<CollisionResult> CollisionSystem::AreBallsColliding(const Ball& lhs, const Ball& rhs) const
+template <typename Policy>
+std::optional<BasicCollisionResult<Policy>> BasicCollisionSystem<Policy>::AreBallsColliding(const BallType& lhs, const BallType& rhs) const
 {
     // Calculate squared distance between centers
-    const sf::Vector2f distanceVec = lhs.m_Position - rhs.m_Position;
-    const float distance2          = DotProduct(distanceVec, distanceVec);
+    const Vector2 distanceVec = lhs.GetPosition() - rhs.GetPosition();
+    const Scalar distance2    = DotProduct(distanceVec, distanceVec);
 
     // Spheres intersect if squared distance is less than squared sum of radii
-    const float radiusSum = lhs.m_Radius + rhs.m_Radius;
+    const Scalar radiusSum = lhs.m_Radius + rhs.m_Radius;
     if (distance2 >= radiusSum * radiusSum) return std::nullopt;
 
-    float distance = std::sqrt(distance2);
-    if (distance == 0.0f) distance = s_BC_KINDA_SMALL_NUMBER;
+    Scalar distance = std::sqrt(distance2);
+    if (distance == Scalar{0}) distance = static_cast<Scalar>(s_BC_KINDA_SMALL_NUMBER);
 
-    const sf::Vector2f normal = distanceVec / distance;
-    const float overlapLength = 0.5f * (distance - radiusSum);
-    return std::make_optional<CollisionResult>(normal, overlapLength);
+    const Vector2 normal       = distanceVec / distance;
+    const Scalar overlapLength = (distance - radiusSum) / 2;
+    return std::make_optional<BasicCollisionResult<Policy>>(normal, overlapLength);
 }
 
-}  // namespace BallCollision
\ No newline at end of file
+// Every policy gets compiled regardless of the one picked, so none of them can silently rot.
+template class BasicCollisionSystem<FloatPolicy>;
+template class BasicCollisionSystem<DoublePolicy>;
+template class BasicCollisionSystem<Fixed16Policy>;
+template class BasicCollisionSystem<Fixed32Policy>;
+
+}  // namespace BallCollision
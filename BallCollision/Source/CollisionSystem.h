@@ -8,37 +8,65 @@
 namespace BallCollision
 {
 
-struct CollisionResult
+template <typename Policy> struct BasicCollisionResult
 {
-    CollisionResult(const sf::Vector2f& normal, const float overlapLength) : m_Normal(normal), m_OverlapLength(overlapLength) {}
-    CollisionResult()  = default;
-    ~CollisionResult() = default;
+    using Scalar  = typename Policy::Scalar;
+    using Vector2 = sf::Vector2<Scalar>;
 
-    sf::Vector2f m_Normal = sf::Vector2f{0.f, 0.f};
-    float m_OverlapLength = 0.f;
+    BasicCollisionResult(const Vector2& normal, const Scalar overlapLength) : m_Normal(normal), m_OverlapLength(overlapLength) {}
+    BasicCollisionResult()  = default;
+    ~BasicCollisionResult() = default;
+
+    Vector2 m_Normal       = {};
+    Scalar m_OverlapLength = {};
 };
 
-class CollisionSystem final
+using CollisionResult = BasicCollisionResult<SimulationPolicy>;
+
+// NOTE: Member functions are defined in CollisionSystem.cpp and explicitly instantiated there for every precision policy.
+template <typename Policy> class BasicCollisionSystem final
 {
   public:
-    CollisionSystem(const sf::Vector2f& screenBounds) noexcept;
-    ~CollisionSystem();
+    using BallType = BasicBall<Policy>;
+    using Scalar   = typename BallType::Scalar;
+    using Vector2  = typename BallType::Vector2;
+
+    BasicCollisionSystem(const Vector2& screenBounds) noexcept;
+    ~BasicCollisionSystem();
 
     FORCEINLINE void DrawDebugColliders(sf::RenderWindow& window) { m_CollisionTree->Show(window); }
 
-    FORCEINLINE void ResizeCollisionTree(const sf::Vector2f& screenBounds)
+    // NOTE: Invalidates the whole tree, nodes and their object lists are handed out again starting with the root.
+    // Bounds are clamped to what the precision policy can store(e.g. 2048 pixels for Fixed16), so walls stay reachable.
+    FORCEINLINE void ResizeCollisionTree(const Vector2& screenBounds)
     {
-        m_CollisionTree->Clear();
-        m_CollisionTree = std::make_unique<QuadTree<8, 8>>(0, sf::FloatRect{{0, 0}, {screenBounds.x, screenBounds.y}}, nullptr);
+        m_NodePool.Reset();
+        m_FrameArena.Reset();
+
+        const Vector2 worldBounds = {std::min(screenBounds.x, Policy::s_MaxCoordinate), std::min(screenBounds.y, Policy::s_MaxCoordinate)};
+
+        m_CollisionTree = m_NodePool.Allocate();
+        m_CollisionTree->Init(&m_NodePool, &m_FrameArena, 0, typename BallType::Rect{{0, 0}, worldBounds}, nullptr);
     }
 
-    void BuildAccelerationStructure(std::vector<Ball>& balls);
-    void SolveCollisions(std::vector<Ball>& balls);
+    void BuildAccelerationStructure(std::vector<BallType>& balls);
+    void SolveCollisions(std::vector<BallType>& balls);
 
   private:
-    std::unique_ptr<QuadTree<8, 8>> m_CollisionTree = nullptr;
+    using CollisionTree = QuadTree<Policy, 8, 8>;
+
+    // NOTE: Node pool is declared after the arena, so nodes are destroyed while their object lists' memory is still alive.
+    Memory::FrameArena m_FrameArena             = {};
+    typename CollisionTree::NodePool m_NodePool = {};
+    CollisionTree* m_CollisionTree              = nullptr;
 
-    FORCEINLINE std::optional<CollisionResult> AreBallsColliding(const Ball& lhs, const Ball& rhs) const;
+    // Per-frame scratch buffers, cleared but never shrunk, so steady-state stepping doesn't allocate.
+    std::vector<BallType*> m_PossibleIntersections                = {};
+    std::vector<std::pair<BallType*, BallType*>> m_CollidingBalls = {};
+
+    FORCEINLINE std::optional<BasicCollisionResult<Policy>> AreBallsColliding(const BallType& lhs, const BallType& rhs) const;
 };
 
-}  // namespace BallCollision
\ No newline at end of file
+using CollisionSystem = BasicCollisionSystem<SimulationPolicy>;
+
+}  // namespace BallCollision
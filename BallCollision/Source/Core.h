@@ -13,10 +13,11 @@ namespace BallCollision
 {
 
 // This one used for collision detection, because in highly dense area, distance between 2 balls may be(almost) zero.
+// NOTE: Both are cast to the simulation scalar at use site, pi is kept as double so double precision doesn't lose digits.
 static constexpr auto s_BC_KINDA_SMALL_NUMBER = 10.E-4f;
-static constexpr float s_PI                   = 3.14159265358979323846f;  // pi
+static constexpr double s_PI                  = 3.14159265358979323846;  // pi
 
-FORCEINLINE float DotProduct(const sf::Vector2f& lhs, const sf::Vector2f& rhs)
+template <typename T> FORCEINLINE T DotProduct(const sf::Vector2<T>& lhs, const sf::Vector2<T>& rhs)
 {
     return lhs.x * rhs.x + lhs.y * rhs.y;
 }
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+#include "Core.h"
+
+namespace BallCollision
+{
+
+namespace Memory
+{
+
+// Monotonic(bump) allocator for data that lives exactly one frame.
+// Deallocation is a no-op, Reset() rewinds to the first chunk and keeps all chunks around,
+// so once the arena has grown to the frame's high-water mark it stops touching the heap.
+// Plugs into std::pmr containers, e.g. std::pmr::vector<T>(&frameArena).
+class FrameArena final : public std::pmr::memory_resource
+{
+  public:
+    FrameArena() = default;
+    explicit FrameArena(const std::size_t chunkSize) : m_ChunkSize(chunkSize) { assert(chunkSize > 0); }
+    ~FrameArena() override = default;
+
+    FrameArena(const FrameArena&)            = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    // NOTE: Everything allocated before is invalidated.
+    FORCEINLINE void Reset()
+    {
+        m_ChunkIndex = 0;
+        m_Offset     = 0;
+    }
+
+  private:
+    struct Chunk
+    {
+        std::unique_ptr<std::byte[]> m_Memory = nullptr;
+        std::size_t m_Size                    = {};
+    };
+
+    std::vector<Chunk> m_Chunks;
+    std::size_t m_ChunkSize  = std::size_t(64) * 1024;
+    std::size_t m_ChunkIndex = {};
+    std::size_t m_Offset     = {};
+
+    void* do_allocate(const std::size_t bytes, const std::size_t alignment) override
+    {
+        // Try the current chunk, then move on to next ones(kept from previous frames), append new one only if nothing fits.
+        for (; m_ChunkIndex < m_Chunks.size(); ++m_ChunkIndex, m_Offset = 0)
+        {
+            auto& chunk           = m_Chunks[m_ChunkIndex];
+            void* memory          = chunk.m_Memory.get() + m_Offset;
+            std::size_t spaceLeft = chunk.m_Size - m_Offset;
+            if (std::align(alignment, bytes, memory, spaceLeft))
+            {
+                m_Offset = static_cast<std::size_t>(static_cast<std::byte*>(memory) - chunk.m_Memory.get()) + bytes;
+                return memory;
+            }
+        }
+
+        // Chunk memory comes from operator new[], which is aligned to __STDCPP_DEFAULT_NEW_ALIGNMENT__ at least.
+        assert(alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+
+        const std::size_t chunkSize = std::max(m_ChunkSize, bytes);
+        m_Chunks.emplace_back(Chunk{std::make_unique<std::byte[]>(chunkSize), chunkSize});
+        m_ChunkIndex = m_Chunks.size() - 1;
+        m_Offset     = bytes;
+
+        return m_Chunks.back().m_Memory.get();
+    }
+
+    void do_deallocate(void*, std::size_t, std::size_t) override {}
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+}  // namespace Memory
+
+}  // namespace BallCollision
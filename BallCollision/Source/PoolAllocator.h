@@ -0,0 +1,51 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "Core.h"
+
+namespace BallCollision
+{
+
+namespace Memory
+{
+
+// Monotonic pool of recyclable objects with stable addresses.
+// Objects are handed out one by one and all of them are returned at once by Reset(), which doesn't free anything,
+// so after the first few frames the pool has grown to its working set and stops touching the heap.
+// NOTE: Objects aren't destroyed on Reset(), caller is responsible for reinitializing them, this way they keep their own buffers.
+template <typename T, std::size_t ChunkSize = std::size_t(256)> class PoolAllocator final
+{
+  private:
+    static_assert(ChunkSize > 0, "PoolAllocator's chunk size must be greater than 0!");
+
+  public:
+    PoolAllocator()  = default;
+    ~PoolAllocator() = default;
+
+    PoolAllocator(const PoolAllocator&)            = delete;
+    PoolAllocator& operator=(const PoolAllocator&) = delete;
+
+    NODISCARD T* Allocate()
+    {
+        const std::size_t chunkIndex = m_UsedCount / ChunkSize;
+
+        // Chunks are never reallocated, only appended, so handed out pointers stay valid.
+        if (chunkIndex == m_Chunks.size()) m_Chunks.emplace_back(std::make_unique<T[]>(ChunkSize));
+
+        T* object = &m_Chunks[chunkIndex][m_UsedCount % ChunkSize];
+        ++m_UsedCount;
+        return object;
+    }
+
+    FORCEINLINE void Reset() { m_UsedCount = 0; }
+
+  private:
+    std::vector<std::unique_ptr<T[]>> m_Chunks;
+    std::size_t m_UsedCount = {};
+};
+
+}  // namespace Memory
+
+}  // namespace BallCollision
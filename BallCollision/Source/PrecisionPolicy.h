@@ -0,0 +1,79 @@
+#pragma once
+
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+
+#include "Core.h"
+
+namespace BallCollision
+{
+
+// Precision policies decide at compile time how the simulation stores and computes things:
+// - Scalar: type all the math is done in(velocities, radii, masses, bounds);
+// - PositionStorage: type ball positions are kept in memory, converted via ToStorage()/FromStorage().
+
+// Plain floating point, positions are stored as is.
+template <typename T> struct FloatingPointPolicy final
+{
+    static_assert(std::is_floating_point_v<T>, "FloatingPointPolicy expects floating point type!");
+
+    using Scalar          = T;
+    using PositionStorage = T;
+
+    static constexpr Scalar s_MaxCoordinate = std::numeric_limits<Scalar>::max();
+
+    NODISCARD static constexpr PositionStorage ToStorage(const Scalar value) { return value; }
+    NODISCARD static constexpr Scalar FromStorage(const PositionStorage value) { return value; }
+};
+
+// Positions are quantized to signed integers with UnitsPerPixel steps per pixel(constexpr world scale).
+// Every written position is snapped onto the grid, so the state itself is bit-exact and independent of the
+// previous rounding history, and positions take 2 or 4 bytes per axis instead of 4 or 8.
+// NOTE: Only the position shrinks, velocity, radius and mass stay at Scalar precision.
+// Scalar has to represent every storage value exactly, that's why 32-bit storage goes with double,
+// which makes Fixed32 ball bigger than the Float one(40 vs 24 bytes), it's there for determinism in large worlds, not for memory.
+template <typename TStorage, uint32_t UnitsPerPixel, typename TScalar> struct QuantizedPositionPolicy final
+{
+    static_assert(std::is_integral_v<TStorage> && std::is_signed_v<TStorage>, "QuantizedPositionPolicy expects signed integral storage!");
+    static_assert(std::is_floating_point_v<TScalar>, "QuantizedPositionPolicy expects floating point scalar!");
+    static_assert(std::numeric_limits<TStorage>::digits <= std::numeric_limits<TScalar>::digits, "Scalar can't represent all storage values!");
+    static_assert(UnitsPerPixel > 0, "QuantizedPositionPolicy's world scale must be greater than 0!");
+
+    using Scalar          = TScalar;
+    using PositionStorage = TStorage;
+
+    static constexpr Scalar s_WorldScale = static_cast<Scalar>(UnitsPerPixel);
+
+    // Representable world range in pixels, positions outside of it are clamped.
+    static constexpr Scalar s_MinCoordinate = static_cast<Scalar>(std::numeric_limits<PositionStorage>::min()) / s_WorldScale;
+    static constexpr Scalar s_MaxCoordinate = static_cast<Scalar>(std::numeric_limits<PositionStorage>::max()) / s_WorldScale;
+
+    NODISCARD static constexpr PositionStorage ToStorage(const Scalar value)
+    {
+        // Round half away from zero by hand, std::round isn't constexpr until C++23.
+        const Scalar scaled = std::clamp(value, s_MinCoordinate, s_MaxCoordinate) * s_WorldScale;
+        return static_cast<PositionStorage>(scaled + (scaled < Scalar{0} ? Scalar{-0.5} : Scalar{0.5}));
+    }
+
+    NODISCARD static constexpr Scalar FromStorage(const PositionStorage value) { return static_cast<Scalar>(value) / s_WorldScale; }
+};
+
+// sizeof(Ball): Float 24, Double 48, Fixed16 20, Fixed32 40 bytes.
+using FloatPolicy   = FloatingPointPolicy<float>;
+using DoublePolicy  = FloatingPointPolicy<double>;                    // Large worlds, no precision loss far from the origin.
+using Fixed16Policy = QuantizedPositionPolicy<int16_t, 16, float>;    // 1/16 pixel steps, [-2048, 2048) pixels.
+using Fixed32Policy = QuantizedPositionPolicy<int32_t, 256, double>;  // 1/256 pixel steps, [-8388608, 8388608) pixels.
+
+// Picked by BC_PRECISION in CMake.
+#if defined(BC_PRECISION_DOUBLE)
+using SimulationPolicy = DoublePolicy;
+#elif defined(BC_PRECISION_FIXED16)
+using SimulationPolicy = Fixed16Policy;
+#elif defined(BC_PRECISION_FIXED32)
+using SimulationPolicy = Fixed32Policy;
+#else
+using SimulationPolicy = FloatPolicy;
+#endif
+
+}  // namespace BallCollision
@@ -2,6 +2,8 @@
 
 #include "Core.h"
 #include "Ball.h"
+#include "PoolAllocator.h"
+#include "FrameArena.h"
 
 #include <array>
 #include <vector>
@@ -14,9 +16,13 @@ namespace BallCollision
 {
 
 // Max number of values a node can contain before we try to split it.
-template <std::size_t DepthThreshold = std::size_t(8), std::size_t ObjectThreshold = std::size_t(16)> class QuadTree final
+template <typename Policy, std::size_t DepthThreshold = std::size_t(8), std::size_t ObjectThreshold = std::size_t(16)> class QuadTree final
 {
   private:
+    using BallType = BasicBall<Policy>;
+    using Scalar   = typename BallType::Scalar;
+    using Rect     = typename BallType::Rect;
+
     enum ESubdivisionType : uint8_t
     {
         SUBDIVISON_TYPE_NORTH_WEST = 0,  // Top left
@@ -27,15 +33,35 @@ template <std::size_t DepthThreshold = std::size_t(8), std::size_t ObjectThresho
     };
 
   public:
+    // Nodes live in a pool and their object lists in a frame arena, both owned by whoever builds the tree,
+    // so rebuilding every frame doesn't touch the heap.
+    using NodePool = Memory::PoolAllocator<QuadTree>;
+
     QuadTree() = default;
-    QuadTree(const uint32_t level, const sf::FloatRect& bounds, QuadTree* parent) : m_Level(level), m_Bounds(bounds), m_ParentNode(parent)
+    ~QuadTree() = default;
+
+    // (Re)initializes pooled node, must be called after the frame arena has been reset.
+    void Init(NodePool* nodePool, Memory::FrameArena* frameArena, const uint32_t level, const Rect& bounds, QuadTree* parent)
     {
+        assert(nodePool && frameArena);
+
+        m_NodePool   = nodePool;
+        m_FrameArena = frameArena;
+        m_Level      = level;
+        m_Bounds     = bounds;
+        m_ParentNode = parent;
+        m_Nodes.fill(nullptr);
+
+        // Old storage belonged to the previous frame, so simply start over.
+        // NOTE: Reconstructing instead of assigning, because polymorphic allocator isn't propagated on assignment.
+        std::destroy_at(&m_Objects);
+        std::construct_at(&m_Objects, frameArena);
+        m_Objects.reserve(ObjectThreshold);
     }
-    ~QuadTree() = default;
 
-    NODISCARD FORCEINLINE const sf::FloatRect& GetBounds() const { return m_Bounds; }
+    NODISCARD FORCEINLINE const Rect& GetBounds() const { return m_Bounds; }
 
-    void Insert(Ball* ball)
+    void Insert(BallType* ball)
     {
         assert(ball);
 
@@ -43,7 +69,7 @@ template <std::size_t DepthThreshold = std::size_t(8), std::size_t ObjectThresho
         const auto bIsLeaf = IsLeaf();
         if (!bIsLeaf)
         {
-            const auto quadrantIndex = GetQuadrantIndex(ball->m_Bounds);
+            const auto quadrantIndex = GetQuadrantIndex(ball->GetBounds());
             if (quadrantIndex != ESubdivisionType::SUBDIVISON_TYPE_NONE)
             {
                 m_Nodes.at(quadrantIndex)->Insert(ball);
@@ -57,45 +83,28 @@ template <std::size_t DepthThreshold = std::size_t(8), std::size_t ObjectThresho
         {
             Subdivide();
 
-            auto objIterator = m_Objects.begin();
-            while (objIterator != m_Objects.end())
+            // Compact objects that stay in this node in-place instead of erasing one by one.
+            std::size_t keptCount = 0;
+            for (BallType* object : m_Objects)
             {
-                auto ball = *objIterator;
-                assert(ball);
+                assert(object);
 
-                const auto quadrantIndex = GetQuadrantIndex(ball->m_Bounds);
+                const auto quadrantIndex = GetQuadrantIndex(object->GetBounds());
                 if (quadrantIndex != ESubdivisionType::SUBDIVISON_TYPE_NONE)
-                {
-                    m_Nodes.at(quadrantIndex)->Insert(ball);
-                    objIterator = m_Objects.erase(objIterator);
-                }
+                    m_Nodes.at(quadrantIndex)->Insert(object);
                 else
-                    ++objIterator;
+                    m_Objects[keptCount++] = object;
             }
 
-            m_Objects.shrink_to_fit();
+            m_Objects.resize(keptCount);
         }
     }
 
-    void Clear()
+    // Fills caller's buffer, so it can be reused across queries without reallocating.
+    void QueryPossibleIntersections(const Rect& area, std::vector<BallType*>& outOverlappedObjects)
     {
-        m_Objects.clear();
-
-        for (auto& child : m_Nodes)
-        {
-            if (!child) continue;
-
-            child->Clear();
-            child.reset();
-        }
-    }
-
-    NODISCARD std::vector<Ball*> QueryPossibleIntersections(const sf::FloatRect& area)
-    {
-        std::vector<Ball*> overlappedObjects = {};
-        QueryPossibleIntersectionsInternal(overlappedObjects, area);
-
-        return overlappedObjects;
+        outOverlappedObjects.clear();
+        QueryPossibleIntersectionsInternal(outOverlappedObjects, area);
     }
 
     void Show(sf::RenderWindow& window) const
@@ -104,8 +113,8 @@ template <std::size_t DepthThreshold = std::size_t(8), std::size_t ObjectThresho
         rect.setOutlineThickness(m_Level * 0.75f);
         rect.setOutlineColor(sf::Color::Green);
         rect.setFillColor(sf::Color::Transparent);
-        rect.setPosition(m_Bounds.left, m_Bounds.top);
-        rect.setSize(sf::Vector2f(m_Bounds.width, m_Bounds.height));
+        rect.setPosition(static_cast<float>(m_Bounds.left), static_cast<float>(m_Bounds.top));
+        rect.setSize(sf::Vector2f(static_cast<float>(m_Bounds.width), static_cast<float>(m_Bounds.height)));
         window.draw(rect);
 
         for (auto& child : m_Nodes)
@@ -117,12 +126,14 @@ template <std::size_t DepthThreshold = std::size_t(8), std::size_t ObjectThresho
     }
 
   private:
-    sf::FloatRect m_Bounds = {};
+    Rect m_Bounds = {};
 
     // nullptr if this is the base node.
-    QuadTree* m_ParentNode = nullptr;
-    std::array<std::unique_ptr<QuadTree>, 4> m_Nodes;
-    std::vector<Ball*> m_Objects;
+    QuadTree* m_ParentNode           = nullptr;
+    NodePool* m_NodePool             = nullptr;
+    Memory::FrameArena* m_FrameArena = nullptr;
+    std::array<QuadTree*, 4> m_Nodes = {};
+    std::pmr::vector<BallType*> m_Objects;
 
     // How deep the current node is from the base node.
     // The first node starts at 0 and then its child node
@@ -136,23 +147,26 @@ template <std::size_t DepthThreshold = std::size_t(8), std::size_t ObjectThresho
         const auto childWidth  = m_Bounds.width / 2;
         const auto childHeight = m_Bounds.height / 2;
 
-        const auto nwBounds                                   = sf::FloatRect(m_Bounds.left, m_Bounds.top, childWidth, childHeight);
-        m_Nodes[ESubdivisionType::SUBDIVISON_TYPE_NORTH_WEST] = std::make_unique<QuadTree>(m_Level + 1, nwBounds, this);
+        for (auto& child : m_Nodes)
+            child = m_NodePool->Allocate();
+
+        const auto nwBounds = Rect(m_Bounds.left, m_Bounds.top, childWidth, childHeight);
+        m_Nodes[ESubdivisionType::SUBDIVISON_TYPE_NORTH_WEST]->Init(m_NodePool, m_FrameArena, m_Level + 1, nwBounds, this);
 
-        const auto neBounds = sf::FloatRect(m_Bounds.left + childWidth, m_Bounds.top, childWidth, childHeight);
-        m_Nodes[ESubdivisionType::SUBDIVISON_TYPE_NORTH_EAST] = std::make_unique<QuadTree>(m_Level + 1, neBounds, this);
+        const auto neBounds = Rect(m_Bounds.left + childWidth, m_Bounds.top, childWidth, childHeight);
+        m_Nodes[ESubdivisionType::SUBDIVISON_TYPE_NORTH_EAST]->Init(m_NodePool, m_FrameArena, m_Level + 1, neBounds, this);
 
-        const auto seBounds = sf::FloatRect(m_Bounds.left + childWidth, m_Bounds.top + childHeight, childWidth, childHeight);
-        m_Nodes[ESubdivisionType::SUBDIVISON_TYPE_SOUTH_EAST] = std::make_unique<QuadTree>(m_Level + 1, seBounds, this);
+        const auto seBounds = Rect(m_Bounds.left + childWidth, m_Bounds.top + childHeight, childWidth, childHeight);
+        m_Nodes[ESubdivisionType::SUBDIVISON_TYPE_SOUTH_EAST]->Init(m_NodePool, m_FrameArena, m_Level + 1, seBounds, this);
 
-        const auto swBounds = sf::FloatRect(m_Bounds.left, m_Bounds.top + childHeight, childWidth, childHeight);
-        m_Nodes[ESubdivisionType::SUBDIVISON_TYPE_SOUTH_WEST] = std::make_unique<QuadTree>(m_Level + 1, swBounds, this);
+        const auto swBounds = Rect(m_Bounds.left, m_Bounds.top + childHeight, childWidth, childHeight);
+        m_Nodes[ESubdivisionType::SUBDIVISON_TYPE_SOUTH_WEST]->Init(m_NodePool, m_FrameArena, m_Level + 1, swBounds, this);
     }
 
-    ESubdivisionType GetQuadrantIndex(const sf::FloatRect& objectBounds) const
+    ESubdivisionType GetQuadrantIndex(const Rect& objectBounds) const
     {
-        const float verticalDividingLine   = m_Bounds.left + m_Bounds.width * 0.5f;
-        const float horizontalDividingLine = m_Bounds.top + m_Bounds.height * 0.5f;
+        const Scalar verticalDividingLine   = m_Bounds.left + m_Bounds.width / 2;
+        const Scalar horizontalDividingLine = m_Bounds.top + m_Bounds.height / 2;
 
         const bool bDoesFitInNorth =
             objectBounds.top < horizontalDividingLine && (objectBounds.height + objectBounds.top < horizontalDividingLine);
@@ -176,18 +190,18 @@ template <std::size_t DepthThreshold = std::size_t(8), std::size_t ObjectThresho
         return ESubdivisionType::SUBDIVISON_TYPE_NONE;
     }
 
-    void QueryPossibleIntersectionsInternal(std::vector<Ball*>& outOverlappingObjects, const sf::FloatRect& area)
+    void QueryPossibleIntersectionsInternal(std::vector<BallType*>& outOverlappingObjects, const Rect& area)
     {
         // 1. Add items from current quadrant if they do overlap.
-        for (Ball* ball : m_Objects)
+        for (BallType* ball : m_Objects)
         {
-            if (!ball || !area.intersects(ball->m_Bounds)) continue;
+            if (!ball || !area.intersects(ball->GetBounds())) continue;
 
             outOverlappingObjects.emplace_back(ball);
         }
 
         // Check if the inner rectangle is completely inside the outer rectangle
-        const auto doesRectContain = [](const sf::FloatRect& outer, const sf::FloatRect& inner)
+        const auto doesRectContain = [](const Rect& outer, const Rect& inner)
         {
             const bool left   = inner.left >= outer.left;
             const bool right  = (inner.left + inner.width) <= (outer.left + outer.width);
@@ -214,9 +228,9 @@ template <std::size_t DepthThreshold = std::size_t(8), std::size_t ObjectThresho
         }
     }
 
-    void PushChildrenObjects(std::vector<Ball*>& outOverlappingObjects)
+    void PushChildrenObjects(std::vector<BallType*>& outOverlappingObjects)
     {
-        for (Ball* ball : m_Objects)
+        for (BallType* ball : m_Objects)
         {
             if (ball) outOverlappingObjects.emplace_back(ball);
         }
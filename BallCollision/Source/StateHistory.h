@@ -0,0 +1,403 @@
+#pragma once
+
+#include "Core.h"
+#include "Ball.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace BallCollision
+{
+
+// Bounded in-memory history of ball positions and velocities, used for rewinding and diffing ticks.
+// Instead of copying the whole ball vector every tick, each tick is stored as a byte stream of per-field deltas
+// against the previous tick(varint encoded), with a keyframe every KeyframeInterval ticks to bound decoding cost.
+// Keyframes store fields raw at their native width, deltas are XOR of the bit patterns for floating point fields
+// (unchanged velocity costs 1 byte) and zigzag-encoded differences for quantized positions(small moves cost 1-2 bytes).
+// All encoded ticks share one byte ring sized from the ball count, so recording doesn't allocate unless the ball count changes.
+// When either the tick or the byte capacity runs out the oldest keyframe is evicted together with its deltas,
+// so the history always starts at a keyframe and every tick in it can be decoded.
+template <typename Policy> class BasicStateHistory final
+{
+  public:
+    using BallType = BasicBall<Policy>;
+
+    BasicStateHistory(const std::size_t tickCapacity, const std::size_t keyframeInterval)
+        : m_Frames(tickCapacity), m_KeyframeInterval(keyframeInterval)
+    {
+        // Interval bigger than capacity would leave the ring without a single keyframe to decode from.
+        assert(keyframeInterval > 0 && keyframeInterval <= tickCapacity);
+    }
+    ~BasicStateHistory() = default;
+
+    NODISCARD FORCEINLINE bool IsEmpty() const { return m_Size == 0; }
+    NODISCARD FORCEINLINE uint64_t GetNewestTick() const { return m_NextTick - 1; }
+
+    // Oldest frame is always a keyframe, so every tick in [GetOldestTick(), GetNewestTick()] can be restored.
+    NODISCARD FORCEINLINE uint64_t GetOldestTick() const { return IsEmpty() ? m_NextTick : GetFrame(0).m_Tick; }
+
+    // Bytes taken by encoded ticks currently in the history.
+    NODISCARD std::size_t GetEncodedSize() const
+    {
+        std::size_t encodedSize = 0;
+        for (std::size_t i{}; i < m_Size; ++i)
+            encodedSize += GetFrame(i).m_Length;
+
+        return encodedSize;
+    }
+
+    // Bytes held overall: byte ring, frame table and encoding/decoding buffers.
+    NODISCARD std::size_t GetMemoryUsage() const
+    {
+        return m_Data.capacity() + m_Frames.capacity() * sizeof(Frame) + m_EncodeBuffer.capacity() +
+               (m_LastState.capacity() + m_Scratch.capacity() + m_DiffScratch.capacity()) * sizeof(uint64_t);
+    }
+
+    void Clear()
+    {
+        m_Head = m_Size = m_DataEnd = 0;
+        m_NextTick = m_TicksSinceKeyframe = 0;
+        m_LastState.clear();
+    }
+
+    // Appends balls' state as the next tick, evicting the oldest keyframe groups if the history is full.
+    void Record(const std::vector<BallType>& balls)
+    {
+        GatherState(balls, m_Scratch);
+
+        // Deltas can't be made against different layout, so ball count change starts the history over with a ring sized for it.
+        if (m_LastState.size() != m_Scratch.size())
+        {
+            Clear();
+            m_Data.resize(GetByteCapacity(balls.size()));
+            m_Data.shrink_to_fit();
+            m_EncodeBuffer.resize(balls.size() * s_MaxBytesPerBall);
+        }
+
+        // Encode into the buffer first, since the exact size is needed to make room in the ring.
+        bool bKeyframe     = IsEmpty() || m_TicksSinceKeyframe >= m_KeyframeInterval;
+        std::size_t length = Encode(bKeyframe);
+
+        if (m_Size == m_Frames.size()) EvictOldestGroup();
+        std::size_t offset = MakeRoom(length);
+
+        // Making room took the group this delta belongs to, so it has to become a keyframe itself(empty ring always fits one).
+        if (IsEmpty() && !bKeyframe)
+        {
+            bKeyframe = true;
+            length    = Encode(bKeyframe);
+            offset    = 0;
+        }
+        if (length > 0) std::memcpy(&m_Data[offset], m_EncodeBuffer.data(), length);
+
+        ++m_Size;
+        auto& frame       = GetFrame(m_Size - 1);
+        frame.m_Tick      = m_NextTick++;
+        frame.m_Offset    = offset;
+        frame.m_Length    = length;
+        frame.m_BallCount = static_cast<uint32_t>(balls.size());
+        frame.m_bKeyframe = bKeyframe;
+        m_DataEnd         = offset + length;
+
+        m_TicksSinceKeyframe = bKeyframe ? 1 : m_TicksSinceKeyframe + 1;
+        std::swap(m_LastState, m_Scratch);
+    }
+
+    // Writes positions and velocities of the given tick into balls, ball count has to match the recorded one.
+    NODISCARD bool Restore(const uint64_t tick, std::vector<BallType>& balls)
+    {
+        if (!DecodeState(tick, m_Scratch) || m_Scratch.size() != balls.size() * s_FieldCount) return false;
+
+        for (std::size_t i{}; i < balls.size(); ++i)
+        {
+            const uint64_t* fields = &m_Scratch[i * s_FieldCount];
+
+            auto& ball        = balls[i];
+            ball.m_Position.x = FromBits<PositionStorage>(fields[0]);
+            ball.m_Position.y = FromBits<PositionStorage>(fields[1]);
+            ball.m_Velocity.x = FromBits<Scalar>(fields[2]);
+            ball.m_Velocity.y = FromBits<Scalar>(fields[3]);
+        }
+
+        return true;
+    }
+
+    // Restores the state tickCount ticks back and drops everything after it, so recording continues from there.
+    NODISCARD bool Rewind(const uint64_t tickCount, std::vector<BallType>& balls)
+    {
+        if (IsEmpty() || tickCount > GetNewestTick() - GetOldestTick()) return false;
+
+        const uint64_t tick = GetNewestTick() - tickCount;
+        if (!Restore(tick, balls)) return false;
+
+        m_Size -= static_cast<std::size_t>(tickCount);
+        m_NextTick = tick + 1;
+        m_DataEnd  = GetFrame(m_Size - 1).m_Offset + GetFrame(m_Size - 1).m_Length;
+        std::swap(m_LastState, m_Scratch);
+
+        m_TicksSinceKeyframe = 1;
+        for (std::size_t i = m_Size - 1; !GetFrame(i).m_bKeyframe; --i)
+            ++m_TicksSinceKeyframe;
+
+        return true;
+    }
+
+    // Fills indices of balls whose position or velocity differs between the two ticks.
+    NODISCARD bool Diff(const uint64_t lhsTick, const uint64_t rhsTick, std::vector<uint32_t>& outChangedBalls)
+    {
+        outChangedBalls.clear();
+        if (!DecodeState(lhsTick, m_Scratch) || !DecodeState(rhsTick, m_DiffScratch) || m_Scratch.size() != m_DiffScratch.size())
+            return false;
+
+        for (std::size_t i{}; i < m_Scratch.size(); i += s_FieldCount)
+        {
+            for (std::size_t field{}; field < s_FieldCount; ++field)
+            {
+                if (m_Scratch[i + field] == m_DiffScratch[i + field]) continue;
+
+                outChangedBalls.emplace_back(static_cast<uint32_t>(i / s_FieldCount));
+                break;
+            }
+        }
+
+        return true;
+    }
+
+  private:
+    using Scalar          = typename BallType::Scalar;
+    using PositionStorage = typename BallType::PositionStorage;
+
+    // Position x, y, velocity x, y.
+    static constexpr std::size_t s_FieldCount = 4;
+
+    // LEB128 carries 7 bits per byte, zigzag adds one bit to integer differences.
+    static constexpr std::size_t GetMaxVarintSize(const std::size_t bitCount) { return (bitCount + 6) / 7; }
+    static constexpr std::size_t s_RawBytesPerBall = 2 * (sizeof(PositionStorage) + sizeof(Scalar));
+    static constexpr std::size_t s_MaxBytesPerBall =
+        std::max(s_RawBytesPerBall, 2 * (GetMaxVarintSize(sizeof(PositionStorage) * 8 + 1) + GetMaxVarintSize(sizeof(Scalar) * 8)));
+
+    // Byte ring budget per ball: tick capacity worth of ticks compressed ~2x(typical for deltas of moving balls),
+    // but never less than two keyframe groups at worst case size, so a full group always stays decodable next to the one being recorded.
+    // Falling short of the expected ratio only means fewer ticks are kept.
+    NODISCARD std::size_t GetByteCapacity(const std::size_t ballCount) const
+    {
+        return ballCount * std::max(m_Frames.size() * s_RawBytesPerBall / 2, 2 * m_KeyframeInterval * s_MaxBytesPerBall);
+    }
+
+    // Encoded bytes live in m_Data[m_Offset, m_Offset + m_Length).
+    struct Frame
+    {
+        uint64_t m_Tick      = {};
+        std::size_t m_Offset = {};
+        std::size_t m_Length = {};
+        uint32_t m_BallCount = {};
+        bool m_bKeyframe     = false;
+    };
+
+    // Ring of frames, m_Head points at the oldest one.
+    std::vector<Frame> m_Frames;
+    std::size_t m_Head               = {};
+    std::size_t m_Size               = {};
+    std::size_t m_KeyframeInterval   = {};
+    std::size_t m_TicksSinceKeyframe = {};
+    uint64_t m_NextTick              = {};
+
+    // Byte ring shared by all frames, frames are never split, if one doesn't fit at the end it starts over at 0.
+    std::vector<uint8_t> m_Data;
+    std::size_t m_DataEnd = {};  // End of the newest frame.
+
+    // Fields of the newest tick as raw bits, base for the next delta.
+    std::vector<uint64_t> m_LastState   = {};
+    std::vector<uint64_t> m_Scratch     = {};
+    std::vector<uint64_t> m_DiffScratch = {};
+    std::vector<uint8_t> m_EncodeBuffer = {};
+
+    FORCEINLINE Frame& GetFrame(const std::size_t index) { return m_Frames[(m_Head + index) % m_Frames.size()]; }
+    FORCEINLINE const Frame& GetFrame(const std::size_t index) const { return m_Frames[(m_Head + index) % m_Frames.size()]; }
+
+    // Evicts the oldest keyframe along with deltas depending on it, deltas without their keyframe can't be decoded.
+    void EvictOldestGroup()
+    {
+        do
+        {
+            m_Head = (m_Head + 1) % m_Frames.size();
+            --m_Size;
+        } while (!IsEmpty() && !GetFrame(0).m_bKeyframe);
+    }
+
+    // Encodes m_Scratch into m_EncodeBuffer, returns the encoded size.
+    std::size_t Encode(const bool bKeyframe)
+    {
+        uint8_t* data = m_EncodeBuffer.data();
+        for (std::size_t i{}; i < m_Scratch.size(); ++i)
+        {
+            if (bKeyframe)
+                WriteRaw(data, i, m_Scratch[i]);
+            else
+                WriteVarint(data, EncodeDelta(i, m_LastState[i], m_Scratch[i]));
+        }
+
+        return static_cast<std::size_t>(data - m_EncodeBuffer.data());
+    }
+
+    // Evicts oldest groups until length bytes fit after the newest frame(or at the ring start), returns the offset.
+    std::size_t MakeRoom(const std::size_t length)
+    {
+        for (;; EvictOldestGroup())
+        {
+            if (IsEmpty()) return 0;
+
+            const std::size_t head = GetFrame(0).m_Offset;
+            if (head < m_DataEnd)  // Live bytes are [head, end), free space is at both sides.
+            {
+                if (m_DataEnd + length <= m_Data.size()) return m_DataEnd;
+                if (length <= head) return 0;
+            }
+            else if (m_DataEnd + length <= head)  // Live bytes wrap around, free space is in between.
+                return m_DataEnd;
+        }
+    }
+
+    // Same width unsigned integer, so floats and quantized positions can be stored as raw bits.
+    template <typename T>
+    using BitsType = std::conditional_t<sizeof(T) == 1, uint8_t,
+                                        std::conditional_t<sizeof(T) == 2, uint16_t, std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>>>;
+
+    template <typename T> NODISCARD static FORCEINLINE uint64_t ToBits(const T value) { return std::bit_cast<BitsType<T>>(value); }
+    template <typename T> NODISCARD static FORCEINLINE T FromBits(const uint64_t bits)
+    {
+        return std::bit_cast<T>(static_cast<BitsType<T>>(bits));
+    }
+
+    NODISCARD static FORCEINLINE bool IsPositionField(const std::size_t fieldIndex) { return fieldIndex % s_FieldCount < 2; }
+
+    NODISCARD static uint64_t EncodeDelta(const std::size_t fieldIndex, const uint64_t previous, const uint64_t current)
+    {
+        if constexpr (std::is_integral_v<PositionStorage>)
+        {
+            if (IsPositionField(fieldIndex))
+            {
+                const int64_t difference = static_cast<int64_t>(FromBits<PositionStorage>(current)) - FromBits<PositionStorage>(previous);
+                return (static_cast<uint64_t>(difference) << 1) ^ static_cast<uint64_t>(difference >> 63);
+            }
+        }
+
+        return previous ^ current;
+    }
+
+    NODISCARD static uint64_t DecodeDelta(const std::size_t fieldIndex, const uint64_t previous, const uint64_t delta)
+    {
+        if constexpr (std::is_integral_v<PositionStorage>)
+        {
+            if (IsPositionField(fieldIndex))
+            {
+                const int64_t difference = static_cast<int64_t>(delta >> 1) ^ -static_cast<int64_t>(delta & 1);
+                return ToBits(static_cast<PositionStorage>(FromBits<PositionStorage>(previous) + difference));
+            }
+        }
+
+        return previous ^ delta;
+    }
+
+    // Keyframe fields are copied as is, so they take exactly as much as the fields themselves.
+    static void WriteRaw(uint8_t*& outData, const std::size_t fieldIndex, const uint64_t bits)
+    {
+        if (IsPositionField(fieldIndex))
+            WriteBits(outData, static_cast<BitsType<PositionStorage>>(bits));
+        else
+            WriteBits(outData, static_cast<BitsType<Scalar>>(bits));
+    }
+
+    template <typename T> static FORCEINLINE void WriteBits(uint8_t*& outData, const T bits)
+    {
+        std::memcpy(outData, &bits, sizeof(T));
+        outData += sizeof(T);
+    }
+
+    NODISCARD static uint64_t ReadRaw(const uint8_t*& data, const std::size_t fieldIndex)
+    {
+        return IsPositionField(fieldIndex) ? ReadBits<BitsType<PositionStorage>>(data) : ReadBits<BitsType<Scalar>>(data);
+    }
+
+    template <typename T> NODISCARD static FORCEINLINE uint64_t ReadBits(const uint8_t*& data)
+    {
+        T bits = {};
+        std::memcpy(&bits, data, sizeof(T));
+        data += sizeof(T);
+        return bits;
+    }
+
+    // LEB128, 7 bits per byte, high bit set means there are more bytes.
+    static void WriteVarint(uint8_t*& outData, uint64_t value)
+    {
+        while (value >= 0x80)
+        {
+            *outData++ = static_cast<uint8_t>(value | 0x80);
+            value >>= 7;
+        }
+        *outData++ = static_cast<uint8_t>(value);
+    }
+
+    NODISCARD static uint64_t ReadVarint(const uint8_t*& data)
+    {
+        uint64_t value = 0;
+        for (uint32_t shift{};; shift += 7)
+        {
+            const uint8_t byte = *data++;
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) break;
+        }
+
+        return value;
+    }
+
+    static void GatherState(const std::vector<BallType>& balls, std::vector<uint64_t>& outState)
+    {
+        outState.resize(balls.size() * s_FieldCount);
+        for (std::size_t i{}; i < balls.size(); ++i)
+        {
+            uint64_t* fields = &outState[i * s_FieldCount];
+            fields[0]        = ToBits(balls[i].m_Position.x);
+            fields[1]        = ToBits(balls[i].m_Position.y);
+            fields[2]        = ToBits(balls[i].m_Velocity.x);
+            fields[3]        = ToBits(balls[i].m_Velocity.y);
+        }
+    }
+
+    // Finds the closest keyframe at or before the tick and applies deltas forward up to the tick.
+    NODISCARD bool DecodeState(const uint64_t tick, std::vector<uint64_t>& outState) const
+    {
+        if (IsEmpty() || tick < GetFrame(0).m_Tick || tick > GetNewestTick()) return false;
+
+        const auto targetIndex = static_cast<std::size_t>(tick - GetFrame(0).m_Tick);
+
+        std::size_t keyframeIndex = targetIndex;
+        while (!GetFrame(keyframeIndex).m_bKeyframe)
+        {
+            --keyframeIndex;
+        }
+
+        const auto& keyframe = GetFrame(keyframeIndex);
+        outState.resize(static_cast<std::size_t>(keyframe.m_BallCount) * s_FieldCount);
+
+        const uint8_t* keyframeData = m_Data.data() + keyframe.m_Offset;
+        for (std::size_t i{}; i < outState.size(); ++i)
+            outState[i] = ReadRaw(keyframeData, i);
+
+        for (std::size_t frameIndex = keyframeIndex + 1; frameIndex <= targetIndex; ++frameIndex)
+        {
+            const uint8_t* data = m_Data.data() + GetFrame(frameIndex).m_Offset;
+            for (std::size_t i{}; i < outState.size(); ++i)
+                outState[i] = DecodeDelta(i, outState[i], ReadVarint(data));
+        }
+
+        return true;
+    }
+};
+
+using StateHistory = BasicStateHistory<SimulationPolicy>;
+
+}  // namespace BallCollision